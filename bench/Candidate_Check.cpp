@@ -0,0 +1,114 @@
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <SurfRec.h>
+
+
+/**
+ *  Checks if two models are identical: same vertices (in the same order) and same faces
+ *
+ *  @param a                first model
+ *  @param b                second model
+ *  @return                 whether both models are identical
+ */
+bool identical(const CGAL::Surface_mesh<Point>& a, const CGAL::Surface_mesh<Point>& b) {
+    if (a.number_of_vertices() != b.number_of_vertices() || a.number_of_faces() != b.number_of_faces()) return false;
+
+    auto va = a.vertices().begin(), vb = b.vertices().begin();
+    for (; va != a.vertices().end(); ++va, ++vb) {
+        if (a.point(*va) != b.point(*vb)) return false;
+    }
+
+    auto fa = a.faces().begin(), fb = b.faces().begin();
+    for (; fa != a.faces().end(); ++fa, ++fb) {
+        std::vector<std::size_t> polygon_a, polygon_b;
+        for (auto v : CGAL::vertices_around_face(a.halfedge(*fa), a)) polygon_a.push_back(v);
+        for (auto v : CGAL::vertices_around_face(b.halfedge(*fb), b)) polygon_b.push_back(v);
+        if (polygon_a != polygon_b) return false;
+    }
+
+    return true;
+}
+
+
+/**
+ *  Measures the candidate generation (construction) of CGAL's sequential polygonal surface reconstruction against the
+ *  parallel one (single and multiple threads) on the same input, the models of the parallel one have to be identical
+ *
+ *  Usage: ./CandidateCheck <Input file name> [<Threads>]
+ *
+ *  @param argc             length of the arguments
+ *  @param argv             list of all given arguments
+ *  @return                 EXIT_SUCCESS if the models with one and multiple threads are identical, otherwise EXIT_FAILURE
+ */
+int main(int argc, char* argv[]) {
+    typedef Pipeline_traits<std::vector<PNI>>::Parallel_reconstruction Parallel_reconstruction;
+    ECODE status;
+
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Wrong number of arguments given!"
+                    << "Use: ./CandidateCheck <Input file name> [<Threads>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string input(argv[1]);
+    unsigned int threads = (argc == 3) ? static_cast<unsigned int>(std::stoul(argv[2])) : 0;
+
+    /// 1) Read points from file and detect shapes once, so all paths get the same planes
+    std::vector<PNI> points;
+    if ((status = SurfRec::File_Handling::readPointsFromFile(points, input, SurfRec::FORMAT::XYZ)) != ECODE::SUCCESS) {
+        std::cerr << "There was an error reading from input file: " << status << std::endl;
+        return EXIT_FAILURE;
+    }
+    if ((status = SurfRec::Shape_Detection::ransac(points)) != ECODE::SUCCESS) {
+        std::cerr << "There was an error using RANSAC for shape detection: " << status << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /// 2) CGAL's sequential constructor
+    CGAL::Surface_mesh<Point> sequential;
+    auto begin = std::chrono::steady_clock::now();
+    Polygonal_surface_reconstruction sequential_algorithm(points, Point_map(), Normal_map(), Plane_index_map());
+    double sequential_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-begin).count();
+    std::cout << "CGAL candidate generation: " << sequential_time << "ms" << std::endl;
+
+    if (!sequential_algorithm.reconstruct<MIP_Solver>(sequential)) {
+        std::cerr << "CGAL reconstruction failed: " << sequential_algorithm.error_message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /// 3) Parallel constructor with one thread and with the given number of threads
+    CGAL::Surface_mesh<Point> single, parallel;
+
+    begin = std::chrono::steady_clock::now();
+    Parallel_reconstruction single_algorithm(points, Point_map(), Normal_map(), Plane_index_map(), 1);
+    double single_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-begin).count();
+    std::cout << "Parallel candidate generation (1 thread): " << single_time << "ms ("
+                << sequential_time / single_time << "x)" << std::endl;
+
+    begin = std::chrono::steady_clock::now();
+    Parallel_reconstruction parallel_algorithm(points, Point_map(), Normal_map(), Plane_index_map(), threads);
+    double parallel_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-begin).count();
+    std::cout << "Parallel candidate generation (" << threads << " threads, 0 := all cores): " << parallel_time
+                << "ms (" << sequential_time / parallel_time << "x)" << std::endl;
+
+    if (!single_algorithm.reconstruct<MIP_Solver>(single) || !parallel_algorithm.reconstruct<MIP_Solver>(parallel)) {
+        std::cerr << "Parallel reconstruction failed: " << single_algorithm.error_message()
+                    << parallel_algorithm.error_message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /// 4) Compare the models: the parallel ones have to be identical, CGAL's one is only reported
+    std::cout << "Candidate faces: " << sequential_algorithm.candidate_faces().number_of_faces() << " (CGAL), "
+                << parallel_algorithm.candidate_faces().number_of_faces() << " (parallel)" << std::endl;
+    std::cout << "Model faces: " << sequential.number_of_faces() << " (CGAL), " << parallel.number_of_faces()
+                << " (parallel)" << std::endl;
+
+    if (!identical(single, parallel)) {
+        std::cerr << "Models with one and multiple threads differ!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Models with one and multiple threads are identical" << std::endl;
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
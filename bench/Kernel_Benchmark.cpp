@@ -0,0 +1,131 @@
+#include <set>
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <iostream>
+#include <CGAL/Random.h>
+#include <SurfRec.h>
+
+
+// RANSAC draws its samples from CGAL's default random generator, reseeding it makes every run (and kernel) comparable
+static const unsigned int RANSAC_SEED = 42;
+
+
+/**
+ *  Runs the given stage multiple times and returns the mean duration
+ *
+ *  @param runs             how often the stage should be run
+ *  @param stage            the stage to run, returns its status
+ *  @param status           status of the last failed run, SUCCESS otherwise
+ *  @return                 mean duration of one run in milliseconds
+ */
+template<typename Stage>
+double timeStage(int runs, Stage stage, ECODE& status) {
+    status = ECODE::SUCCESS;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        ECODE ret = stage();
+        if (ret != ECODE::SUCCESS) status = ret;
+    }
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-begin).count() / runs;
+}
+
+
+/**
+ *  Counts the shapes (planes) points were assigned to by shape detection
+ *
+ *  @param points           the points with their plane indices
+ *  @return                 number of distinct plane indices (unassigned points not counted)
+ */
+template<typename PointRange>
+std::size_t countShapes(const PointRange& points) {
+    std::set<int> shapes;
+    for (const auto& point : points) {
+        if (point.template get<2>() >= 0) shapes.insert(point.template get<2>());
+    }
+
+    return shapes.size();
+}
+
+
+/**
+ *  Runs every shape detection stage on given points
+ *
+ *  @param name             name of the kernel (informational purposes)
+ *  @param input            the input file name (XYZ format)
+ *  @param runs             how often each stage should be run
+ *  @param parameter        parameter used for region growing
+ *  @return                 whether all stages were successful
+ */
+template<typename PointRange>
+bool benchmarkKernel(const std::string& name, const std::string& input, int runs, SurfRec::rg_params& parameter) {
+    ECODE status;
+    PointRange points;
+
+    /// 1) Read points from file
+    double time = timeStage(runs, [&]() {
+        points.clear();
+        return SurfRec::File_Handling::readPointsFromFile(points, input, SurfRec::FORMAT::XYZ);
+    }, status);
+    if (status != ECODE::SUCCESS) {
+        std::cerr << "[" << name << "] There was an error reading from input file: " << status << std::endl;
+        return false;
+    }
+    std::cout << "[" << name << "] Points reading: " << time << "ms" << std::endl;
+
+    /// 2) Shape detection using RANSAC
+    time = timeStage(runs, [&]() {
+        CGAL::get_default_random() = CGAL::Random(RANSAC_SEED);
+        return SurfRec::Shape_Detection::ransac(points);
+    }, status);
+    if (status != ECODE::SUCCESS) {
+        std::cerr << "[" << name << "] There was an error using RANSAC for shape detection: " << status << std::endl;
+        return false;
+    }
+    std::cout << "[" << name << "] RANSAC shape detection: " << time << "ms (" << countShapes(points) << " planes)"
+                << std::endl;
+
+    /// 3) Shape detection using region growing
+    time = timeStage(runs, [&]() { return SurfRec::Shape_Detection::region_growing(points, parameter); }, status);
+    if (status != ECODE::SUCCESS) {
+        std::cerr << "[" << name << "] There was an error using region growing for shape detection: " << status
+                    << std::endl;
+        return false;
+    }
+    std::cout << "[" << name << "] Region growing shape detection: " << time << "ms (" << countShapes(points)
+                << " regions)" << std::endl;
+
+    return true;
+}
+
+
+/**
+ *  Compares the per stage speed of the robust (Epick) and the fast (Simple_cartesian<double>) kernel
+ *
+ *  Usage: ./KernelBenchmark <Input file name> [<Runs> [<Search sphere radius>]]
+ *
+ *  @param argc             length of the arguments
+ *  @param argv             list of all given arguments
+ *  @return                 EXIT_SUCCESS on success, otherwise EXIT_FAILURE
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "Wrong number of arguments given!"
+                    << "Use: ./KernelBenchmark <Input file name> [<Runs> [<Search sphere radius>]]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string input(argv[1]);
+    int runs = (argc > 2) ? std::max(1, std::stoi(argv[2])) : 5;
+    double radius = (argc > 3) ? std::stod(argv[3]) : 1.0;
+
+    // Distance to plane and angle are CGAL's defaults, the region should at least span a triangle
+    SurfRec::rg_params parameter(radius, 1.0, 25.0, 3);
+
+    if (!benchmarkKernel<std::vector<PNI>>("Epick", input, runs, parameter)) return EXIT_FAILURE;
+    if (!benchmarkKernel<std::vector<Fast_PNI>>("Simple_cartesian", input, runs, parameter)) return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -6,6 +6,7 @@
 #define POLYSURFREC_DEFINITIONS_H
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <CGAL/Simple_cartesian.h>
 #include <CGAL/property_map.h>
 
 #include <CGAL/Shape_detection/Efficient_RANSAC.h>
@@ -23,9 +24,10 @@
 #include <CGAL/Polygonal_surface_reconstruction.h>
 
 #include "Error_Handling.h"
+#include "Parallel_polygonal_surface_reconstruction.h"
 
 
-/// 1) Typedefs for data handling
+/// 1) Typedefs for data handling (default kernel, robust predicates)
 typedef CGAL::Exact_predicates_inexact_constructions_kernel     Kernel;
 typedef Kernel::Point_3                                         Point;
 typedef Kernel::Vector_3                                        Vector;
@@ -34,17 +36,49 @@ typedef CGAL::Nth_of_tuple_property_map<0, PNI>                 Point_map;
 typedef CGAL::Nth_of_tuple_property_map<1, PNI>                 Normal_map;
 typedef CGAL::Nth_of_tuple_property_map<2, PNI>                 Plane_index_map;
 
+/// 1.1) Typedefs for data handling (fast kernel, non filtered predicates => only where robustness is not critical)
+typedef CGAL::Simple_cartesian<double>                          Fast_kernel;
+typedef boost::tuple<Fast_kernel::Point_3, Fast_kernel::Vector_3, int>  Fast_PNI;
+
+/// 1.2) Typedefs for data handling derived from a point set (range of point/ normal/ plane index tuples)
+template<typename PointRange>
+struct Pipeline_traits {
+    typedef PointRange                                                  Point_range;
+    typedef typename PointRange::value_type                             Tuple;
+    typedef typename boost::tuples::element<0, Tuple>::type             Point;
+    typedef typename CGAL::Kernel_traits<Point>::Kernel                 Kernel;
+    typedef typename Kernel::Vector_3                                   Vector;
+    typedef CGAL::Nth_of_tuple_property_map<0, Tuple>                   Point_map;
+    typedef CGAL::Nth_of_tuple_property_map<1, Tuple>                   Normal_map;
+    typedef CGAL::Nth_of_tuple_property_map<2, Tuple>                   Plane_index_map;
+
+    // Shape detection: RANSAC
+    typedef CGAL::Shape_detection::Efficient_RANSAC_traits<Kernel, PointRange, Point_map, Normal_map>                   Traits;
+    typedef CGAL::Shape_detection::Efficient_RANSAC<Traits>                                                             Efficient_ransac;
+    typedef CGAL::Shape_detection::Plane<Traits>                                                                        Plane;
+    typedef CGAL::Shape_detection::Point_to_shape_index_map<Traits>                                                     Point_to_shape_index_map;
+
+    // Shape detection: Region Growing
+    typedef CGAL::Shape_detection::Point_set::Sphere_neighbor_query<Kernel, PointRange, Point_map>                      Neighbor_query;
+    typedef CGAL::Shape_detection::Point_set::Least_squares_plane_fit_region<Kernel, PointRange, Point_map, Normal_map> Region_type;
+    typedef CGAL::Shape_detection::Region_growing<PointRange, Neighbor_query, Region_type>                              Region_growing;
+
+    // Surface reconstruction: polygonal surface reconstruction
+    typedef CGAL::Polygonal_surface_reconstruction<Kernel>                                                              Polygonal_surface_reconstruction;
+    typedef ::Parallel_polygonal_surface_reconstruction<Kernel>                                                         Parallel_reconstruction;
+};
+
 
 /// 3.1) Shape detection: Typedefs for RANSAC
-typedef CGAL::Shape_detection::Efficient_RANSAC_traits<Kernel, std::vector<PNI>, Point_map, Normal_map>                     Traits;
-typedef CGAL::Shape_detection::Efficient_RANSAC<Traits>                                                                     Efficient_ransac;
-typedef CGAL::Shape_detection::Plane<Traits>                                                                                Plane;
-typedef CGAL::Shape_detection::Point_to_shape_index_map<Traits>                                                             Point_to_shape_index_map;
+typedef Pipeline_traits<std::vector<PNI>>::Traits                       Traits;
+typedef Pipeline_traits<std::vector<PNI>>::Efficient_ransac             Efficient_ransac;
+typedef Pipeline_traits<std::vector<PNI>>::Plane                        Plane;
+typedef Pipeline_traits<std::vector<PNI>>::Point_to_shape_index_map     Point_to_shape_index_map;
 
 /// 3.2) Shape detection: Typedefs for Region Growing
-typedef CGAL::Shape_detection::Point_set::Sphere_neighbor_query<Kernel, std::vector<PNI>, Point_map>                        Neighbor_query;
-typedef CGAL::Shape_detection::Point_set::Least_squares_plane_fit_region<Kernel, std::vector<PNI>, Point_map, Normal_map>   Region_type;
-typedef CGAL::Shape_detection::Region_growing<std::vector<PNI>, Neighbor_query, Region_type>                                Region_growing;
+typedef Pipeline_traits<std::vector<PNI>>::Neighbor_query               Neighbor_query;
+typedef Pipeline_traits<std::vector<PNI>>::Region_type                  Region_type;
+typedef Pipeline_traits<std::vector<PNI>>::Region_growing               Region_growing;
 
 /// 3.3) Shape detection: Index map to store a mapping of regions found on given points
 class Index_map {
@@ -79,7 +113,7 @@ typedef CGAL::SCIP_mixed_integer_program_traits<double>         MIP_Solver;
 #elif CGAL_USE_GLPK
 typedef CGAL::GLPK_mixed_integer_program_traits<double>         MIP_Solver;
 #endif
-typedef CGAL::Polygonal_surface_reconstruction<Kernel>          Polygonal_surface_reconstruction;
+typedef Pipeline_traits<std::vector<PNI>>::Polygonal_surface_reconstruction    Polygonal_surface_reconstruction;
 
 
 namespace SurfRec {
@@ -137,9 +171,23 @@ namespace SurfRec {
     struct sr_options {
         DETAIL level;               // indicates the level or a user given one
         struct usr_detail* details; // optional user given detail information (level == DETAIL::USER)
+        unsigned int threads;       // threads building the candidate faces of polygonal reconstruction
+                                    // (1 := CGAL's sequential reconstruction, 0 := all cores)
 
-        explicit sr_options(DETAIL nLevel = DETAIL::MOST, struct usr_detail* nDetails = nullptr)
-                : level(nLevel), details(nDetails) {}
+        explicit sr_options(DETAIL nLevel = DETAIL::MOST, struct usr_detail* nDetails = nullptr,
+                            unsigned int nThreads = 1)
+                : level(nLevel), details(nDetails), threads(nThreads) {}
+    };
+
+
+    /// 4.5) Structure to hold mesh decimation options (post processing)
+    struct md_options {
+        std::size_t targetFaces;    // face budget of the decimated model (0 := no budget)
+        double maxCost;             // upper bound on the Lindstrom-Turk collapse cost (0 := no bound)
+        unsigned int threads;       // number of spatial partitions simplified in parallel (0 := all cores)
+
+        explicit md_options(std::size_t nTargetFaces, double nMaxCost = 0.0, unsigned int nThreads = 0)
+                : targetFaces(nTargetFaces), maxCost(nMaxCost), threads(nThreads) {}
     };
 
 
@@ -153,8 +201,12 @@ namespace SurfRec {
         bool shapesGiven;               // are shapes already given in input
         struct sd_options* shapeDet;    // options for shape detection (if no shapes given directly)
 
-        options(FORMAT nIF, FORMAT nOF, struct sr_options nDetail, bool nSG = true, struct sd_options* nSD = nullptr)
-                : inputFormat(nIF), outputFormat(nOF), detail(nDetail), shapesGiven(nSG), shapeDet(nSD) {}
+        struct md_options* decimation;  // optional decimation of the model before it is written to file
+
+        options(FORMAT nIF, FORMAT nOF, struct sr_options nDetail, bool nSG = true, struct sd_options* nSD = nullptr,
+                struct md_options* nMD = nullptr)
+                : inputFormat(nIF), outputFormat(nOF), detail(nDetail), shapesGiven(nSG), shapeDet(nSD),
+                  decimation(nMD) {}
     };
 }
 
@@ -29,6 +29,9 @@ enum ECODE{
     SR_POLY_RECON_FAIL,     // Surface Reconstruction (Polygonal): reconstruction using solver failed
     SR_POISSON_NOT_IMPL,    // Surface Reconstruction (Poisson): level of detail not implemented yet
     SR_POISSON_FAIL,        // Surface Reconstruction (Poisson): reconstruction failed
+
+    MD_WRONG_OPTIONS,       // Mesh Decimation: wrong options given
+    MD_DECIMATION_FAIL,     // Mesh Decimation: model could not be triangulated or partitions could not be stitched
 };
 
 
@@ -0,0 +1,862 @@
+#ifndef POLYSURFREC_PARALLEL_POLYGONAL_SURFACE_RECONSTRUCTION_H
+#define POLYSURFREC_PARALLEL_POLYGONAL_SURFACE_RECONSTRUCTION_H
+
+#include <map>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include <CGAL/Surface_mesh.h>
+#include <CGAL/intersections.h>
+#include <CGAL/Alpha_shape_2.h>
+#include <CGAL/Alpha_shape_vertex_base_2.h>
+#include <CGAL/Alpha_shape_face_base_2.h>
+#include <CGAL/Delaunay_triangulation_2.h>
+#include <CGAL/Triangulation_data_structure_2.h>
+#include <CGAL/compute_average_spacing.h>
+#include <CGAL/linear_least_squares_fitting_3.h>
+#include <CGAL/boost/graph/iterator.h>
+#include <CGAL/Polygon_mesh_processing/bbox.h>
+#include <CGAL/Polygon_mesh_processing/orient_polygon_soup.h>
+#include <CGAL/Polygon_mesh_processing/polygon_soup_to_polygon_mesh.h>
+
+
+/**
+ *  Polygonal surface reconstruction building and scoring the candidate faces in parallel per supporting plane
+ *  => supporting planes are fitted and refined (nearly parallel planes sharing points are merged) as in
+ *     CGAL::Polygonal_surface_reconstruction, candidate faces are the cells of the plane arrangement inside the
+ *     enlarged bounding box of the points
+ *  => per supporting plane (concurrently): its polygon inside the bounding box, the planes intersecting it, the cells
+ *     split off by these planes and their confidences (area, supporting points, covered area)
+ *  => a vertex is identified by the three planes meeting in it and always constructed from them in the same order, so
+ *     all planes share it bit by bit and the results, merged in plane order, do not depend on the number of threads
+ *  => the MIP formulation is the one of CGAL::Polygonal_surface_reconstruction
+ */
+template<typename GeomTraits>
+class Parallel_polygonal_surface_reconstruction {
+public:
+    typedef GeomTraits                                                          Kernel;
+    typedef typename Kernel::FT                                                 FT;
+    typedef typename Kernel::Point_2                                            Point_2;
+    typedef typename Kernel::Point_3                                            Point;
+    typedef typename Kernel::Vector_3                                           Vector;
+    typedef typename Kernel::Plane_3                                            Plane;
+    typedef CGAL::Surface_mesh<Point>                                           Polygon_mesh;
+    typedef typename Polygon_mesh::Face_index                                   Face_descriptor;
+    typedef typename Polygon_mesh::Halfedge_index                               Halfedge_descriptor;
+    typedef typename Polygon_mesh::Vertex_index                                 Vertex_descriptor;
+
+    typedef std::array<std::size_t, 3>                                          Vertex_key;     // planes of a vertex
+    typedef std::vector<Halfedge_descriptor>                                    Intersection;   // fan of an edge
+    typedef std::vector<Intersection>                                           Adjacency;
+
+    /**
+     *  Builds the candidate faces and scores them
+     *
+     *  @param points           input points with normals and plane indices
+     *  @param point_map        property map of the points
+     *  @param normal_map       property map of the normals (not needed to build the candidate faces)
+     *  @param index_map        property map of the plane indices
+     *  @param threads          number of threads building and scoring the candidate faces (0 := all cores)
+     */
+    template<typename PointRange, typename PointMap, typename NormalMap, typename IndexMap>
+    Parallel_polygonal_surface_reconstruction(const PointRange& points, PointMap point_map, NormalMap /*normal_map*/,
+                                                IndexMap index_map, unsigned int threads = 0)
+            : m_bounds(), m_supportingPlanes(0), m_numPoints(points.size()) {
+        if (points.empty()) {
+            m_error = "empty input points";
+            return;
+        }
+
+        // Points of each planar segment, a plane can only be fitted to at least 3 points
+        std::vector<Point> input;
+        std::vector<std::vector<std::size_t>> segments;
+        for (const auto& p : points) {
+            input.push_back(get(point_map, p));
+
+            int plane = get(index_map, p);
+            if (plane < 0) continue;
+            if (static_cast<std::size_t>(plane) >= segments.size()) segments.resize(plane + 1);
+            segments[plane].push_back(input.size() - 1);
+        }
+        segments.erase(std::remove_if(segments.begin(), segments.end(), [](const std::vector<std::size_t>& s) {
+            return s.size() < 3;
+        }), segments.end());
+
+        if (segments.size() < 4) {
+            m_error = "at least 4 planes required to reconstruct a closed surface mesh (only "
+                        + std::to_string(segments.size()) + " provided)";
+            return;
+        }
+
+        refinePlanes(input, segments);
+        generate(input, segments, threads);
+    }
+
+    /**
+     *  Selects the candidate faces forming the model by solving the MIP
+     *  => the candidate faces are left untouched, so it can be run again (e.g. with other weights)
+     *
+     *  @param output_mesh      output surface mesh
+     *  @param wt_fitting       weight for the data fitting
+     *  @param wt_coverage      weight for the point coverage
+     *  @param wt_complexity    weight for the model complexity
+     *  @return                 whether the reconstruction was successful (see error_message otherwise)
+     */
+    template<typename MixedIntegerProgramTraits, typename PolygonMesh>
+    bool reconstruct(PolygonMesh& output_mesh, double wt_fitting = 0.43, double wt_coverage = 0.27,
+                        double wt_complexity = 0.3);
+
+    /// Candidate faces with their confidences (informational purposes)
+    const Polygon_mesh& candidate_faces() const { return m_candidates; }
+
+    /// Error message of the last failed step, empty if there was none
+    const std::string& error_message() const { return m_error; }
+
+private:
+    /// Convex cell of the arrangement on one supporting plane
+    struct Cell {
+        std::vector<Vertex_key> vertices;   // counterclockwise around the plane normal
+        std::vector<std::size_t> edges;     // plane cutting out the edge from each vertex to the next one
+        std::vector<std::size_t> points;    // projected supporting points strictly inside the cell
+    };
+
+    /// Candidate faces of one supporting plane with their confidences
+    struct Plane_candidates {
+        std::vector<Cell> cells;
+        std::map<Vertex_key, Point> vertices;
+        std::vector<FT> areas;
+        std::vector<std::size_t> supportingPoints;
+        std::vector<FT> coveredAreas;
+    };
+
+    /**
+     *  Fits a plane to the points of a planar segment (least squares)
+     *
+     *  @param points           all input points
+     *  @param segment          indices of the points of the segment
+     *  @return                 the fitted plane
+     */
+    static Plane fitPlane(const std::vector<Point>& points, const std::vector<std::size_t>& segment);
+
+    /**
+     *  Merges nearly parallel planar segments sharing points and stores their supporting planes (largest first)
+     *
+     *  @param points           all input points
+     *  @param segments         indices of the points of each segment, reordered as the supporting planes
+     */
+    void refinePlanes(const std::vector<Point>& points, std::vector<std::vector<std::size_t>>& segments);
+
+    /**
+     *  Builds the candidate faces and their confidences, concurrently per supporting plane
+     *
+     *  @param points           all input points
+     *  @param segments         indices of the points of each supporting plane
+     *  @param threads          number of threads (0 := all cores)
+     */
+    void generate(const std::vector<Point>& points, const std::vector<std::vector<std::size_t>>& segments,
+                    unsigned int threads);
+
+    /**
+     *  Builds the candidate faces of one supporting plane and scores them
+     *
+     *  @param i                index of the supporting plane
+     *  @param points           all input points
+     *  @param segment          indices of the points of the supporting plane
+     *  @param spacing          average spacing of all input points
+     *  @param candidates       where to store the candidate faces
+     */
+    void buildCandidates(std::size_t i, const std::vector<Point>& points, const std::vector<std::size_t>& segment,
+                            FT spacing, Plane_candidates& candidates) const;
+
+    /**
+     *  Computes the polygon of a supporting plane inside the bounding box
+     *
+     *  @param i                index of the supporting plane
+     *  @param vertices         constructed vertices of the plane
+     *  @param polygon          where to store the polygon
+     *  @return                 whether the plane intersects the bounding box
+     */
+    bool boxPolygon(std::size_t i, std::map<Vertex_key, Point>& vertices, Cell& polygon) const;
+
+    /**
+     *  Splits a cell on a supporting plane by another plane, its supporting points are passed on to the halves
+     *
+     *  @param i                index of the supporting plane of the cell
+     *  @param j                index of the cutting plane
+     *  @param cell             the cell to split
+     *  @param projected        supporting points projected onto the supporting plane
+     *  @param vertices         constructed vertices of the supporting plane
+     *  @param lower            where to store the half on the negative side
+     *  @param upper            where to store the half on the positive side
+     *  @return                 whether the plane cuts through the cell
+     */
+    bool splitCell(std::size_t i, std::size_t j, const Cell& cell, const std::vector<Point>& projected,
+                    std::map<Vertex_key, Point>& vertices, Cell& lower, Cell& upper) const;
+
+    /**
+     *  Returns the vertex where three planes meet, constructed once per supporting plane
+     *
+     *  @param key              sorted indices of the three planes
+     *  @param vertices         constructed vertices of the supporting plane
+     *  @return                 the vertex
+     */
+    const Point& vertex(const Vertex_key& key, std::map<Vertex_key, Point>& vertices) const;
+
+    /**
+     *  Computes the area covered by points on a plane (interior of their alpha shape)
+     *
+     *  @param points           the points in the frame of the plane
+     *  @param alpha            squared radius of the alpha shape
+     *  @return                 the covered area
+     */
+    static FT coveredArea(const std::vector<Point_2>& points, FT alpha);
+
+    /**
+     *  Groups the halfedges of all candidate faces sharing an edge (identified by the keys of its end points)
+     *
+     *  @return                 the fans of all edges
+     */
+    Adjacency extractAdjacency() const;
+
+    /// Sorted key of the vertex where three planes meet
+    static Vertex_key makeKey(std::size_t a, std::size_t b, std::size_t c) {
+        Vertex_key key = {{a, b, c}};
+        std::sort(key.begin(), key.end());
+        return key;
+    }
+
+    std::vector<Plane> m_planes;        // supporting planes (largest segment first), then the bounding box faces
+    std::array<FT, 6> m_bounds;         // enlarged bounding box: xmin, xmax, ymin, ymax, zmin, zmax
+    std::size_t m_supportingPlanes;
+    std::size_t m_numPoints;
+    Polygon_mesh m_candidates;
+    std::string m_error;
+};
+
+
+template<typename GeomTraits>
+typename Parallel_polygonal_surface_reconstruction<GeomTraits>::Plane
+Parallel_polygonal_surface_reconstruction<GeomTraits>::fitPlane(const std::vector<Point>& points,
+                                                                const std::vector<std::size_t>& segment) {
+    std::vector<Point> pts;
+    pts.reserve(segment.size());
+    for (std::size_t idx : segment) pts.push_back(points[idx]);
+
+    Plane plane;
+    CGAL::linear_least_squares_fitting_3(pts.begin(), pts.end(), plane, CGAL::Dimension_tag<0>());
+    return plane;
+}
+
+
+template<typename GeomTraits>
+void Parallel_polygonal_surface_reconstruction<GeomTraits>::refinePlanes(const std::vector<Point>& points,
+                                                                        std::vector<std::vector<std::size_t>>& segments) {
+    // 1) Fit the planes, the mean of the maximum point distances of all segments is the distance threshold
+    std::vector<Plane> planes;
+    FT avg_max_dist = 0;
+    for (const std::vector<std::size_t>& segment : segments) {
+        planes.push_back(fitPlane(points, segment));
+
+        FT max_dist = 0;
+        for (std::size_t idx : segment) {
+            max_dist = std::max(max_dist, CGAL::approximate_sqrt(CGAL::squared_distance(points[idx], planes.back())));
+        }
+        avg_max_dist += max_dist;
+    }
+    avg_max_dist /= static_cast<FT>(segments.size());
+
+    auto normal = [](const Plane& plane) {
+        Vector n = plane.orthogonal_vector();
+        return n / CGAL::approximate_sqrt(n.squared_length());
+    };
+    auto pointsOnPlane = [&](const std::vector<std::size_t>& segment, const Plane& plane) {
+        std::size_t count = 0;
+        for (std::size_t idx : segment) {
+            if (CGAL::approximate_sqrt(CGAL::squared_distance(points[idx], plane)) < avg_max_dist) ++count;
+        }
+        return count;
+    };
+
+    // 2) Merge nearly parallel planes (10 degrees) sharing points, smaller (less confident) segments first
+    const FT cos_theta = std::cos(CGAL_PI * 10.0 / 180.0);
+    auto bySize = [&segments](std::size_t a, std::size_t b) { return segments[a].size() < segments[b].size(); };
+
+    bool merged = true;
+    while (merged) {
+        merged = false;
+
+        std::vector<std::size_t> order(segments.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), bySize);
+
+        for (std::size_t a = 0; a < order.size() && !merged; ++a) {
+            std::size_t s1 = order[a];
+            Vector n1 = normal(planes[s1]);
+            double threshold = static_cast<double>(segments[s1].size()) / 5.0;
+
+            for (std::size_t b = a + 1; b < order.size() && !merged; ++b) {
+                std::size_t s2 = order[b];
+                if (CGAL::abs(n1 * normal(planes[s2])) <= cos_theta) continue;
+
+                if (static_cast<double>(pointsOnPlane(segments[s1], planes[s2])) > threshold
+                        || static_cast<double>(pointsOnPlane(segments[s2], planes[s1])) > threshold) {
+                    segments[s1].insert(segments[s1].end(), segments[s2].begin(), segments[s2].end());
+                    planes[s1] = fitPlane(points, segments[s1]);
+
+                    segments.erase(segments.begin() + s2);
+                    planes.erase(planes.begin() + s2);
+                    merged = true;
+                }
+            }
+        }
+    }
+
+    // 3) Supporting planes ordered by decreasing number of points
+    std::vector<std::size_t> order(segments.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&bySize](std::size_t a, std::size_t b) { return bySize(b, a); });
+
+    std::vector<std::vector<std::size_t>> sorted;
+    for (std::size_t s : order) {
+        sorted.push_back(std::move(segments[s]));
+        m_planes.push_back(planes[s]);
+    }
+    segments.swap(sorted);
+    m_supportingPlanes = m_planes.size();
+}
+
+
+template<typename GeomTraits>
+void Parallel_polygonal_surface_reconstruction<GeomTraits>::generate(const std::vector<Point>& points,
+                                        const std::vector<std::vector<std::size_t>>& segments, unsigned int threads) {
+    // 1) Bounding box of the points enlarged by 5% of its half diagonal, its faces follow the supporting planes
+    CGAL::Bbox_3 box;
+    for (const Point& p : points) box += p.bbox();
+
+    double dx = box.xmax() - box.xmin();
+    double dy = box.ymax() - box.ymin();
+    double dz = box.zmax() - box.zmin();
+    double offset = 0.05 * 0.5 * std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    m_bounds = {{FT(box.xmin() - offset), FT(box.xmax() + offset), FT(box.ymin() - offset), FT(box.ymax() + offset),
+                 FT(box.zmin() - offset), FT(box.zmax() + offset)}};
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        for (std::size_t side = 0; side < 2; ++side) {
+            m_planes.push_back(Plane(FT(axis == 0 ? 1 : 0), FT(axis == 1 ? 1 : 0), FT(axis == 2 ? 1 : 0),
+                                     -m_bounds[2 * axis + side]));
+        }
+    }
+
+    // 2) Inputs shared by all supporting planes are computed once
+    FT spacing = CGAL::compute_average_spacing<CGAL::Sequential_tag>(points, 6);
+
+    // 3) Candidate faces of each supporting plane, the planes are taken by the threads one after another
+    std::size_t count = (threads == 0) ? std::thread::hardware_concurrency() : threads;
+    count = std::max<std::size_t>(1, std::min<std::size_t>(count, m_supportingPlanes));
+
+    std::vector<Plane_candidates> candidates(m_supportingPlanes);
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+
+    auto work = [&]() {
+        for (std::size_t i = next++; i < m_supportingPlanes; i = next++) {
+            try {
+                buildCandidates(i, points, segments[i], spacing, candidates[i]);
+            } catch (...) {
+                // CGAL reports failed preconditions by exceptions, they must not terminate the process
+                failed = true;
+            }
+        }
+    };
+
+    if (count == 1) {
+        work();
+    } else {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < count; ++t) workers.emplace_back(work);
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    if (failed) {
+        m_error = "building the candidate faces failed";
+        return;
+    }
+
+    // 4) Merge in plane order: faces of one plane share their vertices, each plane is a component of its own
+    auto supporting_planes = m_candidates.template add_property_map<Face_descriptor, const Plane*>("f:supp_plane",
+                                                                                                     nullptr).first;
+    auto face_areas = m_candidates.template add_property_map<Face_descriptor, FT>("f:face_area", FT(0)).first;
+    auto face_num_supporting_points =
+            m_candidates.template add_property_map<Face_descriptor, std::size_t>("f:num_supporting_points", 0).first;
+    auto face_covered_areas = m_candidates.template add_property_map<Face_descriptor, FT>("f:covered_area", FT(0)).first;
+    auto vertex_keys = m_candidates.template add_property_map<Vertex_descriptor, Vertex_key>("v:planes").first;
+
+    for (std::size_t i = 0; i < m_supportingPlanes; ++i) {
+        const Plane_candidates& plane = candidates[i];
+        std::map<Vertex_key, Vertex_descriptor> added;
+
+        for (std::size_t c = 0; c < plane.cells.size(); ++c) {
+            std::vector<Vertex_descriptor> polygon;
+            for (const Vertex_key& key : plane.cells[c].vertices) {
+                auto it = added.find(key);
+                if (it == added.end()) {
+                    Vertex_descriptor v = m_candidates.add_vertex(plane.vertices.at(key));
+                    vertex_keys[v] = key;
+                    it = added.emplace(key, v).first;
+                }
+                polygon.push_back(it->second);
+            }
+
+            Face_descriptor f = m_candidates.add_face(polygon);
+            if (f == Polygon_mesh::null_face()) {
+                m_error = "candidate faces of a supporting plane do not form a subdivision";
+                return;
+            }
+
+            supporting_planes[f] = &m_planes[i];
+            face_areas[f] = plane.areas[c];
+            face_num_supporting_points[f] = plane.supportingPoints[c];
+            face_covered_areas[f] = plane.coveredAreas[c];
+        }
+    }
+}
+
+
+template<typename GeomTraits>
+void Parallel_polygonal_surface_reconstruction<GeomTraits>::buildCandidates(std::size_t i,
+                                        const std::vector<Point>& points, const std::vector<std::size_t>& segment,
+                                        FT spacing, Plane_candidates& candidates) const {
+    const Plane& plane = m_planes[i];
+    std::map<Vertex_key, Point>& vertices = candidates.vertices;
+
+    // 1) Polygon of the supporting plane inside the bounding box
+    Cell polygon;
+    if (!boxPolygon(i, vertices, polygon)) return;
+
+    // 2) Supporting points projected onto the plane, only the ones strictly inside the box can support a face
+    std::vector<Point> projected;
+    for (std::size_t idx : segment) {
+        Point p = plane.projection(points[idx]);
+        if (p.x() > m_bounds[0] && p.x() < m_bounds[1] && p.y() > m_bounds[2] && p.y() < m_bounds[3]
+                && p.z() > m_bounds[4] && p.z() < m_bounds[5]) {
+            polygon.points.push_back(projected.size());
+            projected.push_back(p);
+        }
+    }
+
+    // 3) Planes intersecting the polygon, i.e. with vertices strictly on both sides
+    std::vector<std::size_t> cuts;
+    for (std::size_t j = 0; j < m_supportingPlanes; ++j) {
+        if (j == i) continue;
+
+        bool negative = false, positive = false;
+        for (const Vertex_key& key : polygon.vertices) {
+            CGAL::Oriented_side side = m_planes[j].oriented_side(vertex(key, vertices));
+            negative |= (side == CGAL::ON_NEGATIVE_SIDE);
+            positive |= (side == CGAL::ON_POSITIVE_SIDE);
+        }
+        if (negative && positive) cuts.push_back(j);
+    }
+
+    // 4) Split all cells by each intersecting plane in plane order, as every cut runs through the whole polygon the
+    //    cells form a subdivision without T-junctions
+    candidates.cells.push_back(std::move(polygon));
+    for (std::size_t j : cuts) {
+        std::vector<Cell> cells;
+        for (Cell& cell : candidates.cells) {
+            Cell lower, upper;
+            if (splitCell(i, j, cell, projected, vertices, lower, upper)) {
+                cells.push_back(std::move(lower));
+                cells.push_back(std::move(upper));
+            } else {
+                cells.push_back(std::move(cell));
+            }
+        }
+        candidates.cells.swap(cells);
+    }
+
+    // 5) Confidences measured in an orthonormal frame of the plane, coverage by alpha shapes of 5 times the spacing
+    Point origin = plane.point();
+    Vector u = plane.base1();
+    u = u / CGAL::approximate_sqrt(u.squared_length());
+    Vector v = CGAL::cross_product(plane.orthogonal_vector(), u);
+    v = v / CGAL::approximate_sqrt(v.squared_length());
+
+    auto to2d = [&](const Point& p) { return Point_2((p - origin) * u, (p - origin) * v); };
+    FT alpha = (5 * spacing) * (5 * spacing);
+
+    for (Cell& cell : candidates.cells) {
+        std::vector<Point_2> corners;
+        for (const Vertex_key& key : cell.vertices) corners.push_back(to2d(vertex(key, vertices)));
+
+        FT area = 0;
+        for (std::size_t k = 0; k < corners.size(); ++k) {
+            const Point_2& p = corners[k];
+            const Point_2& q = corners[(k + 1) % corners.size()];
+            area += p.x() * q.y() - q.x() * p.y();
+        }
+        area = CGAL::abs(area) / 2;
+
+        std::vector<Point_2> supporting;
+        for (std::size_t p : cell.points) supporting.push_back(to2d(projected[p]));
+
+        candidates.areas.push_back(area);
+        candidates.supportingPoints.push_back(supporting.size());
+        candidates.coveredAreas.push_back(supporting.size() < 3 ? FT(0)
+                                                                : std::min(area, coveredArea(supporting, alpha)));
+
+        std::vector<std::size_t>().swap(cell.points);
+    }
+}
+
+
+template<typename GeomTraits>
+bool Parallel_polygonal_surface_reconstruction<GeomTraits>::boxPolygon(std::size_t i,
+                                                        std::map<Vertex_key, Point>& vertices, Cell& polygon) const {
+    const Plane& plane = m_planes[i];
+
+    // 1) Box edges crossed by the plane, given by their two box faces (corners on the plane count as positive)
+    std::vector<std::pair<std::size_t, std::size_t>> crossings;
+    for (std::size_t t = 0; t < 3; ++t) {
+        std::size_t a = (t + 1) % 3, b = (t + 2) % 3;
+        for (std::size_t sa = 0; sa < 2; ++sa) {
+            for (std::size_t sb = 0; sb < 2; ++sb) {
+                std::array<FT, 3> corner;
+                corner[a] = m_bounds[2 * a + sa];
+                corner[b] = m_bounds[2 * b + sb];
+
+                corner[t] = m_bounds[2 * t];
+                bool below = plane.oriented_side(Point(corner[0], corner[1], corner[2])) == CGAL::ON_NEGATIVE_SIDE;
+                corner[t] = m_bounds[2 * t + 1];
+                bool above = plane.oriented_side(Point(corner[0], corner[1], corner[2])) == CGAL::ON_NEGATIVE_SIDE;
+
+                if (below != above) {
+                    crossings.emplace_back(m_supportingPlanes + 2 * a + sa, m_supportingPlanes + 2 * b + sb);
+                }
+            }
+        }
+    }
+    if (crossings.size() < 3) return false;
+
+    // 2) Consecutive vertices share a box face, walking in either direction around the polygon
+    auto walk = [&](bool forward) {
+        Cell cell;
+        std::size_t current = 0;
+        std::size_t via = forward ? crossings[0].second : crossings[0].first;
+
+        for (std::size_t k = 0; k < crossings.size(); ++k) {
+            cell.vertices.push_back(makeKey(i, crossings[current].first, crossings[current].second));
+            cell.edges.push_back(via);
+
+            std::size_t c = 0;
+            while (c < crossings.size() && (c == current || (crossings[c].first != via && crossings[c].second != via))) {
+                ++c;
+            }
+            if (c == crossings.size()) throw std::runtime_error("plane does not cut the bounding box into a polygon");
+
+            current = c;
+            via = (crossings[current].first == via) ? crossings[current].second : crossings[current].first;
+        }
+        if (current != 0) throw std::runtime_error("plane does not cut the bounding box into a polygon");
+
+        return cell;
+    };
+
+    // 3) Counterclockwise around the plane normal
+    polygon = walk(true);
+
+    Vector normal = CGAL::NULL_VECTOR;
+    const Point& first = vertex(polygon.vertices[0], vertices);
+    for (std::size_t k = 1; k + 1 < polygon.vertices.size(); ++k) {
+        normal = normal + CGAL::cross_product(vertex(polygon.vertices[k], vertices) - first,
+                                                vertex(polygon.vertices[k + 1], vertices) - first);
+    }
+    if (normal * plane.orthogonal_vector() < 0) polygon = walk(false);
+
+    return true;
+}
+
+
+template<typename GeomTraits>
+bool Parallel_polygonal_surface_reconstruction<GeomTraits>::splitCell(std::size_t i, std::size_t j, const Cell& cell,
+                                        const std::vector<Point>& projected, std::map<Vertex_key, Point>& vertices,
+                                        Cell& lower, Cell& upper) const {
+    const Plane& cut = m_planes[j];
+    std::size_t m = cell.vertices.size();
+
+    // 1) Sides of the vertices, the cell is only split if vertices lie strictly on both sides
+    std::vector<CGAL::Oriented_side> sides(m);
+    bool negative = false, positive = false;
+    for (std::size_t k = 0; k < m; ++k) {
+        sides[k] = cut.oriented_side(vertex(cell.vertices[k], vertices));
+        negative |= (sides[k] == CGAL::ON_NEGATIVE_SIDE);
+        positive |= (sides[k] == CGAL::ON_POSITIVE_SIDE);
+    }
+    if (!negative || !positive) return false;
+
+    // 2) Vertices of both halves: original vertex k or the crossing of the cut with edge k
+    struct Entry {
+        Vertex_key key;
+        bool crossing;
+        std::size_t k;
+    };
+
+    std::vector<Entry> below, above;
+    for (std::size_t k = 0; k < m; ++k) {
+        std::size_t n = (k + 1) % m;
+
+        if (sides[k] != CGAL::ON_POSITIVE_SIDE) below.push_back({cell.vertices[k], false, k});
+        if (sides[k] != CGAL::ON_NEGATIVE_SIDE) above.push_back({cell.vertices[k], false, k});
+
+        if ((sides[k] == CGAL::ON_NEGATIVE_SIDE && sides[n] == CGAL::ON_POSITIVE_SIDE)
+                || (sides[k] == CGAL::ON_POSITIVE_SIDE && sides[n] == CGAL::ON_NEGATIVE_SIDE)) {
+            Entry crossing = {makeKey(i, cell.edges[k], j), true, k};
+            below.push_back(crossing);
+            above.push_back(crossing);
+        }
+    }
+
+    // 3) Edges between consecutive vertices either follow edge k of the cell or the cut
+    auto build = [&](const std::vector<Entry>& entries, Cell& half) {
+        for (std::size_t t = 0; t < entries.size(); ++t) {
+            const Entry& a = entries[t];
+            const Entry& b = entries[(t + 1) % entries.size()];
+
+            bool along = (!b.crossing && b.k == (a.k + 1) % m) || (!a.crossing && b.crossing && b.k == a.k);
+            half.vertices.push_back(a.key);
+            half.edges.push_back(along ? cell.edges[a.k] : j);
+        }
+    };
+    build(below, lower);
+    build(above, upper);
+
+    // 4) Supporting points on the cut lie on the border of both halves, so they support neither
+    for (std::size_t p : cell.points) {
+        CGAL::Oriented_side side = cut.oriented_side(projected[p]);
+        if (side == CGAL::ON_NEGATIVE_SIDE) lower.points.push_back(p);
+        else if (side == CGAL::ON_POSITIVE_SIDE) upper.points.push_back(p);
+    }
+
+    return true;
+}
+
+
+template<typename GeomTraits>
+const typename Parallel_polygonal_surface_reconstruction<GeomTraits>::Point&
+Parallel_polygonal_surface_reconstruction<GeomTraits>::vertex(const Vertex_key& key,
+                                                                std::map<Vertex_key, Point>& vertices) const {
+    auto it = vertices.find(key);
+    if (it != vertices.end()) return it->second;
+
+    auto result = CGAL::intersection(m_planes[key[0]], m_planes[key[1]], m_planes[key[2]]);
+    const Point* point = result ? boost::get<Point>(&*result) : nullptr;
+    if (!point) throw std::runtime_error("planes of a vertex do not meet in a single point");
+
+    return vertices.emplace(key, *point).first->second;
+}
+
+
+template<typename GeomTraits>
+typename Parallel_polygonal_surface_reconstruction<GeomTraits>::FT
+Parallel_polygonal_surface_reconstruction<GeomTraits>::coveredArea(const std::vector<Point_2>& points, FT alpha) {
+    typedef CGAL::Alpha_shape_vertex_base_2<Kernel>                             Alpha_vertex;
+    typedef CGAL::Alpha_shape_face_base_2<Kernel>                               Alpha_face;
+    typedef CGAL::Triangulation_data_structure_2<Alpha_vertex, Alpha_face>      Alpha_tds;
+    typedef CGAL::Delaunay_triangulation_2<Kernel, Alpha_tds>                   Alpha_triangulation;
+    typedef CGAL::Alpha_shape_2<Alpha_triangulation>                            Alpha_shape;
+
+    Alpha_shape shape(points.begin(), points.end(), alpha, Alpha_shape::GENERAL);
+
+    FT area = 0;
+    for (auto f = shape.finite_faces_begin(); f != shape.finite_faces_end(); ++f) {
+        if (shape.classify(f) != Alpha_shape::INTERIOR) continue;
+        area += CGAL::abs(CGAL::area(f->vertex(0)->point(), f->vertex(1)->point(), f->vertex(2)->point()));
+    }
+
+    return area;
+}
+
+
+template<typename GeomTraits>
+typename Parallel_polygonal_surface_reconstruction<GeomTraits>::Adjacency
+Parallel_polygonal_surface_reconstruction<GeomTraits>::extractAdjacency() const {
+    auto vertex_keys = m_candidates.template property_map<Vertex_descriptor, Vertex_key>("v:planes").first;
+
+    std::map<std::pair<Vertex_key, Vertex_key>, Intersection> fans;
+    for (Face_descriptor f : m_candidates.faces()) {
+        for (Halfedge_descriptor h : CGAL::halfedges_around_face(m_candidates.halfedge(f), m_candidates)) {
+            Vertex_key s = vertex_keys[m_candidates.source(h)];
+            Vertex_key t = vertex_keys[m_candidates.target(h)];
+            if (t < s) std::swap(s, t);
+
+            fans[std::make_pair(s, t)].push_back(h);
+        }
+    }
+
+    Adjacency adjacency;
+    adjacency.reserve(fans.size());
+    for (auto& fan : fans) adjacency.push_back(std::move(fan.second));
+
+    return adjacency;
+}
+
+
+template<typename GeomTraits>
+template<typename MixedIntegerProgramTraits, typename PolygonMesh>
+bool Parallel_polygonal_surface_reconstruction<GeomTraits>::reconstruct(PolygonMesh& output_mesh, double wt_fitting,
+                                                                        double wt_coverage, double wt_complexity) {
+    typedef MixedIntegerProgramTraits                                       MIP_Solver;
+    typedef typename MIP_Solver::Variable                                   Variable;
+    typedef typename MIP_Solver::Linear_objective                           Linear_objective;
+    typedef typename MIP_Solver::Linear_constraint                          Linear_constraint;
+
+    // An error has occurred while building the candidate faces
+    if (!m_error.empty()) return false;
+
+    auto face_num_supporting_points =
+            m_candidates.template property_map<Face_descriptor, std::size_t>("f:num_supporting_points").first;
+    auto face_areas = m_candidates.template property_map<Face_descriptor, FT>("f:face_area").first;
+    auto face_covered_areas = m_candidates.template property_map<Face_descriptor, FT>("f:covered_area").first;
+    auto face_supporting_planes = m_candidates.template property_map<Face_descriptor, const Plane*>("f:supp_plane").first;
+    auto vertex_keys = m_candidates.template property_map<Vertex_descriptor, Vertex_key>("v:planes").first;
+
+    // 1) Index of each face := index of its variable
+    std::vector<std::size_t> face_indices(m_candidates.num_faces());
+    std::size_t idx = 0;
+    for (Face_descriptor f : m_candidates.faces()) face_indices[f] = idx++;
+
+    const Adjacency adjacency = extractAdjacency();
+    if (adjacency.empty()) {
+        m_error = "no candidate faces";
+        return false;
+    }
+
+    // 2) Scale: all actual values are multiplied by the total number of points
+    double total_points = static_cast<double>(m_numPoints);
+
+    const CGAL::Bbox_3 box = CGAL::Polygon_mesh_processing::bbox(m_candidates);
+    double dx = box.xmax() - box.xmin();
+    double dy = box.ymax() - box.ymin();
+    double dz = box.zmax() - box.zmin();
+    double box_area = 2.0 * (dx * dy + dy * dz + dz * dx);
+
+    double coeff_data_fitting = wt_fitting;
+    double coeff_coverage = total_points * wt_coverage / box_area;
+    double coeff_complexity = total_points * wt_complexity / static_cast<double>(adjacency.size());
+
+    // 3) Variables: faces, usage of intersecting edges, sharpness of intersecting edges (all binary)
+    std::size_t num_faces = m_candidates.number_of_faces();
+    std::size_t num_edges = 0;
+    std::vector<std::size_t> edge_usage(adjacency.size(), 0);
+    for (std::size_t i = 0; i < adjacency.size(); ++i) {
+        if (adjacency[i].size() == 4) edge_usage[i] = num_faces + num_edges++;
+    }
+
+    MIP_Solver solver;
+    const std::vector<Variable*>& variables = solver.create_variables(num_faces + num_edges + num_edges);
+    for (Variable* v : variables) v->set_variable_type(Variable::BINARY);
+
+    // 4) Objective: data fitting, coverage and model complexity
+    Linear_objective* objective = solver.create_objective(Linear_objective::MINIMIZE);
+    for (Face_descriptor f : m_candidates.faces()) {
+        std::size_t var_idx = face_indices[f];
+
+        double num = static_cast<double>(face_num_supporting_points[f]);
+        objective->add_coefficient(variables[var_idx], -coeff_data_fitting * num);
+
+        double uncovered_area = CGAL::to_double(face_areas[f] - face_covered_areas[f]);
+        objective->add_coefficient(variables[var_idx], coeff_coverage * uncovered_area);
+    }
+
+    std::size_t num_sharp_edges = 0;
+    for (std::size_t i = 0; i < adjacency.size(); ++i) {
+        if (adjacency[i].size() != 4) continue;
+        objective->add_coefficient(variables[num_faces + num_edges + num_sharp_edges++], coeff_complexity);
+    }
+
+    // 5) Constraints: an edge is used by exactly two or no faces (open surfaces are not allowed)
+    std::size_t var_edge_used_idx = 0;
+    for (std::size_t i = 0; i < adjacency.size(); ++i) {
+        Linear_constraint* c = solver.create_constraint(0.0, 0.0);
+        const Intersection& fan = adjacency[i];
+        for (std::size_t j = 0; j < fan.size(); ++j) {
+            c->add_coefficient(variables[face_indices[m_candidates.face(fan[j])]], 1.0);
+        }
+
+        if (fan.size() == 4) c->add_coefficient(variables[num_faces + var_edge_used_idx++], -2.0);
+    }
+
+    // 6) Constraints: a sharp edge must be used, two selected faces on different planes make an edge sharp
+    double M = 1.0;
+    for (std::size_t i = 0; i < adjacency.size(); ++i) {
+        const Intersection& fan = adjacency[i];
+        if (fan.size() != 4) continue;
+
+        std::size_t var_edge_usage_idx = edge_usage[i];
+        std::size_t var_edge_sharp_idx = var_edge_usage_idx + num_edges;
+
+        Linear_constraint* c = solver.create_constraint(0.0);
+        c->add_coefficient(variables[var_edge_usage_idx], 1.0);
+        c->add_coefficient(variables[var_edge_sharp_idx], -1.0);
+
+        for (std::size_t j = 0; j < fan.size(); ++j) {
+            Face_descriptor f1 = m_candidates.face(fan[j]);
+            const Plane* plane1 = face_supporting_planes[f1];
+            std::size_t fid1 = face_indices[f1];
+            for (std::size_t k = j + 1; k < fan.size(); ++k) {
+                Face_descriptor f2 = m_candidates.face(fan[k]);
+                const Plane* plane2 = face_supporting_planes[f2];
+                std::size_t fid2 = face_indices[f2];
+                if (plane1 == plane2) continue;
+
+                // X[sharp] + M * (3 - (X[fid1] + X[fid2] + X[usage])) >= 1
+                c = solver.create_constraint(1.0 - 3.0 * M);
+                c->add_coefficient(variables[var_edge_sharp_idx], 1.0);
+                c->add_coefficient(variables[fid1], -M);
+                c->add_coefficient(variables[fid2], -M);
+                c->add_coefficient(variables[var_edge_usage_idx], -M);
+            }
+        }
+    }
+
+    // 7) Solve, the selected faces are stitched by the planes of their vertices (candidate faces stay untouched)
+    if (!solver.solve()) {
+        m_error = "solving the binary program failed: " + solver.error_message();
+        return false;
+    }
+
+    const std::vector<double>& X = solver.solution();
+    std::vector<Point> points;
+    std::vector<std::vector<std::size_t>> polygons;
+    std::map<Vertex_key, std::size_t> indices;
+
+    for (Face_descriptor f : m_candidates.faces()) {
+        if (static_cast<int>(std::round(X[face_indices[f]])) == 0) continue;
+
+        std::vector<std::size_t> polygon;
+        for (Vertex_descriptor v : CGAL::vertices_around_face(m_candidates.halfedge(f), m_candidates)) {
+            auto it = indices.find(vertex_keys[v]);
+            if (it == indices.end()) {
+                it = indices.emplace(vertex_keys[v], points.size()).first;
+                points.push_back(m_candidates.point(v));
+            }
+            polygon.push_back(it->second);
+        }
+        polygons.push_back(std::move(polygon));
+    }
+
+    CGAL::Polygon_mesh_processing::orient_polygon_soup(points, polygons);
+    CGAL::Polygon_mesh_processing::polygon_soup_to_polygon_mesh(points, polygons, output_mesh);
+    return true;
+}
+
+
+#endif //POLYSURFREC_PARALLEL_POLYGONAL_SURFACE_RECONSTRUCTION_H
@@ -37,13 +37,18 @@ namespace SurfRec {
     /**
      *  Runs polygonal surface reconstruction from given points and outputs to given model
      *  => used when shapes already detected (due to shape detection or given in input file)
+     *  => CGAL's sequential reconstruction by default, with level.threads != 1 the candidate faces are built and scored
+     *     in parallel per supporting plane (the output does not depend on the number of threads)
+     *  => exported for std::vector<PNI>
      * 
      *  @param points           input points for reconstruction (after shape detection)
      *  @param model            output surface mesh
      *  @param level            level of detail, the reconstruction should be
      *  @return                 SUCCESS if reconstruction was successful, an error otherwise
      */
-    DLL ECODE polygonalReconstruction(std::vector<PNI>& points, CGAL::Surface_mesh<Point>& model,
+    template<typename PointRange>
+    DLL ECODE polygonalReconstruction(PointRange& points,
+                                        CGAL::Surface_mesh<typename Pipeline_traits<PointRange>::Point>& model,
                                         struct SurfRec::sr_options& level);
 
     /*******************************************************************************************************************
@@ -52,15 +57,28 @@ namespace SurfRec {
      *
      ******************************************************************************************************************/
 
+    /**
+     *  Runs poisson surface reconstruction from given file and outputs it to new file
+     *  => shapes are not needed, so shape detection options are ignored
+     *
+     *  @param path             path to file (output path := path + ".out")
+     *  @param algOptions       the options used in the whole reconstruction process, start to finish
+     *  @return                 SUCCESS if reconstruction was successful, an error otherwise
+     */
+    DLL ECODE poissonReconstruction(std::string& path, struct SurfRec::options& algOptions);
+
     /**
      *  Runs poisson surface reconstruction from given points and outputs to given model
+     *  => exported for std::vector<PNI>
      *
      *  @param points           input points for reconstruction
      *  @param model            output surface mesh
      *  @param level            level of detail, the reconstruction should be
      *  @return                 SUCCESS if reconstruction was successful, an error otherwise
      */
-    DLL ECODE poissonReconstruction(std::vector<PNI>& points, CGAL::Surface_mesh<Point>& model,
+    template<typename PointRange>
+    DLL ECODE poissonReconstruction(PointRange& points,
+                                        CGAL::Surface_mesh<typename Pipeline_traits<PointRange>::Point>& model,
                                         struct SurfRec::sr_options& level);
 
 
@@ -72,19 +90,23 @@ namespace SurfRec {
     namespace Shape_Detection {
         /**
          *  Efficient RANSAC for shape detection
+         *  => exported for std::vector<PNI> and std::vector<Fast_PNI>
          * 
          *  @param points       points used to find/ store shapes
          *  @return             SUCCESS if RANSAC ran successful, an error otherwise
          */
-        DLL ECODE ransac(std::vector<PNI>& points);
+        template<typename PointRange>
+        DLL ECODE ransac(PointRange& points);
 
         /**
          *  Region growing for shape detection using file specific parameter
+         *  => exported for std::vector<PNI> and std::vector<Fast_PNI>
          * 
          *  @param points       points used to find/ store shapes
          *  @param parameter    SUCCESS if Region Growing finished successful, an error otherwise
          */
-        DLL ECODE region_growing(std::vector<PNI>& points, struct SurfRec::rg_params& parameter);
+        template<typename PointRange>
+        DLL ECODE region_growing(PointRange& points, struct SurfRec::rg_params& parameter);
     }
 
 
@@ -96,13 +118,15 @@ namespace SurfRec {
     namespace File_Handling {
         /**
          *  Reads points (with properties) from a file in PLY or XYZ / OFF format
+         *  => exported for std::vector<PNI> and std::vector<Fast_PNI>
          *
          *  @param points           where to store the points
          *  @param filepath         path to the file to load from
          *  @param format           input format: PLY (user defined planes), XYZ / OFF (point cloud)
          *  @return                 SUCCESS, a error code otherwise
          */
-        DLL ECODE readPointsFromFile(std::vector<PNI>& points, const std::string& filepath, SurfRec::FORMAT format);
+        template<typename PointRange>
+        DLL ECODE readPointsFromFile(PointRange& points, const std::string& filepath, SurfRec::FORMAT format);
 
         /**
          *  Writes a generated surface model to a file in PLY or XYZ / OFF format
@@ -115,6 +139,30 @@ namespace SurfRec {
         DLL ECODE writeModelToFile(const CGAL::Surface_mesh<Point>& model, const std::string& filepath,
                                     SurfRec::FORMAT format);
     }
+
+
+    /*******************************************************************************************************************
+     *
+     *      5) MESH DECIMATION
+     *
+     ******************************************************************************************************************/
+    namespace Mesh_Decimation {
+        /**
+         *  Simplifies a reconstructed model to a face budget and/ or error bound
+         *  => default: edge collapses on spatial partitions simplified in parallel with their borders locked,
+         *     followed by a pass over the whole model with the borders unlocked (polygonal faces get triangulated)
+         *  => planar: adjacent faces on the same plane are joined into polygons, no vertex is moved
+         *  => a face budget already met by the model leaves it untouched, otherwise the budget is best effort
+         *
+         *  @param model            the model to simplify (only replaced if decimation was successful)
+         *  @param parameter        face budget, error bound and number of threads
+         *  @param reachedFaces     where to store the face count of the model afterwards
+         *  @param planar           keeps planar regions exact (used for polygonal surface reconstruction output)
+         *  @return                 SUCCESS if decimation was successful, an error otherwise
+         */
+        DLL ECODE decimate(CGAL::Surface_mesh<Point>& model, struct SurfRec::md_options& parameter,
+                            std::size_t& reachedFaces, bool planar = false);
+    }
 }
 
 
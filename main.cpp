@@ -20,7 +20,7 @@ inline bool regex(const char* str, const char* expr, std::regex::flag_type flags
 /**
  *  The main routine, running RANSAC shape detection and polygonal surface reconstruction on given file
  *
- *  Usage: ./PolySurfRec <Input file name> <Poly | Poisson> <Output file name>
+ *  Usage: ./PolySurfRec <Input file name> <Poly | Poisson> <Output file name> [<Target faces>]
  *
  *  @param argc             length of the arguments
  *  @param argv             list of all given arguments
@@ -30,15 +30,21 @@ int main(int argc, char* argv[]) {
     ECODE status;
 
     /// 1) Check arguments (input/ output file name)
-    if (argc != 4) {
+    if (argc != 4 && argc != 5) {
         std::cerr << "Not enough arguments given!"
-                     << "Use: ./PolySurfRec <Input file name> <Poly | Poisson> <Output file name>" << std::endl;
+                     << "Use: ./PolySurfRec <Input file name> <Poly | Poisson> <Output file name> [<Target faces>]" << std::endl;
         return EXIT_FAILURE;
     }
 
     if (!regex(argv[2], "(poly|poisson)", std::regex_constants::ECMAScript | std::regex_constants::icase)) {
         std::cerr << "Wrong surface reconstruction algorithm given!"
-                    << "Use: ./PolySurfRec <Input file name> <Poly | Poisson> <Output file name>" << std::endl;
+                    << "Use: ./PolySurfRec <Input file name> <Poly | Poisson> <Output file name> [<Target faces>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (argc == 5 && !regex(argv[4], "^[0-9]{1,18}$", std::regex_constants::ECMAScript)) {
+        std::cerr << "Wrong target faces given!"
+                    << "Use: ./PolySurfRec <Input file name> <Poly | Poisson> <Output file name> [<Target faces>]" << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -46,6 +52,7 @@ int main(int argc, char* argv[]) {
 
     std::string input(argv[1]);
     std::string output(argv[3]);
+    std::size_t target_faces = (argc == 5) ? std::stoul(argv[4]) : 0;
 
 
     /// 2) Read points from file
@@ -101,6 +108,23 @@ int main(int argc, char* argv[]) {
     }
 
 
+    /// 4.3) Decimation to the face budget (if given), planar regions of polygonal output stay exact
+    if (target_faces > 0) {
+        SurfRec::md_options decimation_options(target_faces);
+        std::size_t reached_faces;
+
+        begin = std::chrono::steady_clock::now();
+        if ((status = SurfRec::Mesh_Decimation::decimate(model, decimation_options, reached_faces, use_poly))
+                != ECODE::SUCCESS) {
+            std::cerr << "There was an error decimating the model: " << status << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Mesh decimation done correctly (" << reached_faces << " faces)! Time: "
+                    << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now()-begin).count() << "s"
+                    << std::endl;
+    }
+
+
     /// 5) Write model to file
     begin = std::chrono::steady_clock::now();
     if ((status = SurfRec::File_Handling::writeModelToFile(model, output, SurfRec::FORMAT::OFF)) != ECODE::SUCCESS) {
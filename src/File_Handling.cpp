@@ -50,7 +50,10 @@ bool isFile(const char* path) {
 
 
 /// Loads points (with properties) from a file in PLY or XYZ / OFF format
-ECODE SurfRec::File_Handling::readPointsFromFile(std::vector<PNI>& points, const std::string& filepath, SurfRec::FORMAT format) {
+template<typename PointRange>
+ECODE SurfRec::File_Handling::readPointsFromFile(PointRange& points, const std::string& filepath, SurfRec::FORMAT format) {
+    typedef Pipeline_traits<PointRange> Types;
+
     if (!isFile(filepath.c_str())) {
         // File does not exist or is no file
         return ECODE::FH_LOAD_EXIST_FAIL;
@@ -65,10 +68,10 @@ ECODE SurfRec::File_Handling::readPointsFromFile(std::vector<PNI>& points, const
     switch (format) {
         case FORMAT::PLY:
             if (!CGAL::read_ply_points_with_properties(input, std::back_inserter(points),
-                    CGAL::make_ply_point_reader(Point_map()),
-                    CGAL::make_ply_normal_reader(Normal_map()),
+                    CGAL::make_ply_point_reader(typename Types::Point_map()),
+                    CGAL::make_ply_normal_reader(typename Types::Normal_map()),
                     std::make_pair(
-                            Plane_index_map(),
+                            typename Types::Plane_index_map(),
                             CGAL::PLY_property<int>("segment_index")))) {
                 // Cannot read file!
                 return ECODE::FH_LOAD_PLY_FAIL;
@@ -76,7 +79,7 @@ ECODE SurfRec::File_Handling::readPointsFromFile(std::vector<PNI>& points, const
             break;
         case FORMAT::XYZ:
             if (!CGAL::read_xyz_points(input, std::back_inserter(points),
-                    CGAL::parameters::point_map(Point_map()).normal_map(Normal_map()))) {
+                    CGAL::parameters::point_map(typename Types::Point_map()).normal_map(typename Types::Normal_map()))) {
                 // Cannot read file!
                 return ECODE::FH_LOAD_XYZ_FAIL;
             }
@@ -116,4 +119,9 @@ ECODE SurfRec::File_Handling::writeModelToFile(const CGAL::Surface_mesh<Point>&
     }
 
     return SUCCESS;
-}
\ No newline at end of file
+}
+
+
+/// Explicit instantiations exported from the library (robust and fast kernel)
+template ECODE SurfRec::File_Handling::readPointsFromFile<std::vector<PNI>>(std::vector<PNI>&, const std::string&, SurfRec::FORMAT);
+template ECODE SurfRec::File_Handling::readPointsFromFile<std::vector<Fast_PNI>>(std::vector<Fast_PNI>&, const std::string&, SurfRec::FORMAT);
\ No newline at end of file
@@ -0,0 +1,397 @@
+#include <map>
+#include <set>
+#include <array>
+#include <cmath>
+#include <thread>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include <CGAL/Surface_mesh.h>
+#include <CGAL/boost/graph/helpers.h>
+#include <CGAL/boost/graph/Euler_operations.h>
+#include <CGAL/Polygon_mesh_processing/triangulate_faces.h>
+#include <CGAL/Polygon_mesh_processing/polygon_soup_to_polygon_mesh.h>
+#include <CGAL/Surface_mesh_simplification/edge_collapse.h>
+#include <CGAL/Surface_mesh_simplification/Policies/Edge_collapse/LindstromTurk_cost.h>
+#include <CGAL/Surface_mesh_simplification/Policies/Edge_collapse/LindstromTurk_placement.h>
+
+#include "SurfRec.h"
+
+
+namespace SMS = CGAL::Surface_mesh_simplification;
+
+typedef CGAL::Surface_mesh<Point>                               Mesh;
+typedef Mesh::Property_map<Mesh::Edge_index, bool>              Locked_edge_map;
+
+
+namespace {
+    /**
+     *  Stops the edge collapse when the face budget is reached or the error bound is exceeded
+     *  => the budget is given as ratio of the initial edges, as the number of edges of a triangle mesh scales with its faces
+     */
+    class Budget_stop_predicate {
+    public:
+        Budget_stop_predicate(bool nBudget, double nRatio, double nMaxCost)
+                : m_budget(nBudget), m_ratio(nRatio), m_maxCost(nMaxCost) {}
+
+        template<typename FT, typename Profile>
+        bool operator()(const FT& current_cost, const Profile&, std::size_t initial_edge_count,
+                        std::size_t current_edge_count) const {
+            if (m_maxCost > 0.0 && CGAL::to_double(current_cost) > m_maxCost) return true;
+            return m_budget
+                    && static_cast<double>(current_edge_count) <= m_ratio * static_cast<double>(initial_edge_count);
+        }
+    private:
+        bool m_budget;      // whether a face budget is given at all
+        double m_ratio;     // ratio of edges to keep (only used with a budget)
+        double m_maxCost;   // upper bound on the collapse cost (0 := no bound)
+    };
+
+
+    /**
+     *  Placement keeping every vertex on a locked edge at its position
+     *  => edges between two locked vertices are not collapsed at all, so partition borders can be stitched exactly
+     */
+    class Locked_placement : public SMS::LindstromTurk_placement<Mesh> {
+    public:
+        explicit Locked_placement(const Locked_edge_map& nLocked) : m_locked(nLocked) {}
+
+        template<typename Profile>
+        boost::optional<typename Profile::Point> operator()(const Profile& profile) const {
+            bool locked0 = isLocked(profile.v0(), profile.surface_mesh());
+            bool locked1 = isLocked(profile.v1(), profile.surface_mesh());
+
+            if (locked0 && locked1) return boost::none;
+            if (locked0) return profile.p0();
+            if (locked1) return profile.p1();
+            return SMS::LindstromTurk_placement<Mesh>::operator()(profile);
+        }
+    private:
+        bool isLocked(Mesh::Vertex_index v, const Mesh& mesh) const {
+            for (Mesh::Halfedge_index h : CGAL::halfedges_around_target(v, mesh)) {
+                if (get(m_locked, mesh.edge(h))) return true;
+            }
+            return false;
+        }
+
+        Locked_edge_map m_locked;
+    };
+
+
+    /// One spatial partition of the model, simplified independently from all others
+    struct Partition {
+        Mesh mesh;                                  // faces of the model inside the partition
+        std::vector<std::vector<Point>> kept;       // faces which could not be added to the mesh (passed through as is)
+    };
+
+
+    /**
+     *  Splits the faces of the model into partitions of equal size along the longest axis of its bounding box
+     *
+     *  @param model            the model to split
+     *  @param count            number of partitions
+     *  @return                 the faces of each partition
+     */
+    std::vector<std::vector<Mesh::Face_index>> partitionFaces(const Mesh& model, std::size_t count) {
+        std::vector<Mesh::Face_index> faces(model.faces().begin(), model.faces().end());
+        std::vector<std::array<double, 3>> centroids(model.number_of_faces() + model.number_of_removed_faces());
+
+        CGAL::Bbox_3 bbox;
+        for (Mesh::Face_index f : faces) {
+            std::array<double, 3> centroid = {0.0, 0.0, 0.0};
+            std::size_t degree = 0;
+            for (Mesh::Vertex_index v : CGAL::vertices_around_face(model.halfedge(f), model)) {
+                const Point& p = model.point(v);
+                centroid[0] += p.x();
+                centroid[1] += p.y();
+                centroid[2] += p.z();
+                bbox += p.bbox();
+                ++degree;
+            }
+            for (double& c : centroid) c /= static_cast<double>(degree);
+            centroids[f] = centroid;
+        }
+
+        // Longest axis of the bounding box
+        int axis = 0;
+        for (int i = 1; i < 3; ++i) {
+            if (bbox.max(i) - bbox.min(i) > bbox.max(axis) - bbox.min(axis)) axis = i;
+        }
+
+        std::sort(faces.begin(), faces.end(), [&](Mesh::Face_index a, Mesh::Face_index b) {
+            return centroids[a][axis] < centroids[b][axis];
+        });
+
+        std::vector<std::vector<Mesh::Face_index>> partitions(count);
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            partitions[i * count / faces.size()].push_back(faces[i]);
+        }
+
+        return partitions;
+    }
+
+
+    /**
+     *  Copies the faces of one partition into its own mesh and simplifies it with its border locked
+     *
+     *  @param model            the whole model (read only)
+     *  @param faces            faces of the model inside the partition
+     *  @param stop             stop predicate (face budget and/ or error bound)
+     *  @param partition        where to store the simplified partition
+     */
+    void decimatePartition(const Mesh& model, const std::vector<Mesh::Face_index>& faces,
+                            const Budget_stop_predicate& stop, Partition& partition) {
+        Mesh& mesh = partition.mesh;
+        std::unordered_map<std::size_t, Mesh::Vertex_index> vmap;
+
+        // 1) Copy faces, those which would make the partition non manifold are kept as they are
+        for (Mesh::Face_index f : faces) {
+            std::vector<Mesh::Vertex_index> polygon;
+            for (Mesh::Vertex_index v : CGAL::vertices_around_face(model.halfedge(f), model)) {
+                auto it = vmap.find(v);
+                if (it == vmap.end()) it = vmap.emplace(v, mesh.add_vertex(model.point(v))).first;
+                polygon.push_back(it->second);
+            }
+
+            if (mesh.add_face(polygon) == Mesh::null_face()) {
+                std::vector<Point> kept;
+                for (Mesh::Vertex_index v : polygon) kept.push_back(mesh.point(v));
+                partition.kept.push_back(kept);
+            }
+        }
+
+        // 2) Lock the border of the partition
+        Locked_edge_map locked = mesh.add_property_map<Mesh::Edge_index, bool>("e:locked", false).first;
+        for (Mesh::Edge_index e : mesh.edges()) {
+            locked[e] = mesh.is_border(e);
+        }
+
+        // 3) Simplify
+        SMS::edge_collapse(mesh, stop,
+                CGAL::parameters::edge_is_constrained_map(locked)
+                    .get_cost(SMS::LindstromTurk_cost<Mesh>())
+                    .get_placement(Locked_placement(locked)));
+    }
+
+
+    /**
+     *  Computes the normal of a (nearly) planar polygon using Newell's method
+     *
+     *  @param mesh             the mesh containing the face
+     *  @param h                a halfedge of the face
+     *  @return                 the normal of the face, not normalized (null vector for degenerate faces)
+     */
+    Vector faceNormal(const Mesh& mesh, Mesh::Halfedge_index h) {
+        double x = 0.0, y = 0.0, z = 0.0;
+        for (Mesh::Halfedge_index c : CGAL::halfedges_around_face(h, mesh)) {
+            const Point& p = mesh.point(mesh.source(c));
+            const Point& q = mesh.point(mesh.target(c));
+            x += (p.y() - q.y()) * (p.z() + q.z());
+            y += (p.z() - q.z()) * (p.x() + q.x());
+            z += (p.x() - q.x()) * (p.y() + q.y());
+        }
+        return Vector(x, y, z);
+    }
+
+
+    /**
+     *  Checks if the two faces of a halfedge lie on the same plane and can be joined into one simple polygon
+     *  => vertices of polygonal reconstruction are constructed by inexact plane intersections, so coplanarity is
+     *     decided with a distance tolerance instead of exact predicates
+     *
+     *  @param mesh             the mesh containing the faces
+     *  @param h                halfedge between both faces
+     *  @param tolerance        maximum distance of a vertex to the plane of the other face
+     *  @return                 whether removing the edge of the halfedge keeps the planar regions
+     */
+    bool isMergeable(const Mesh& mesh, Mesh::Halfedge_index h, double tolerance) {
+        Mesh::Halfedge_index o = mesh.opposite(h);
+        if (mesh.is_border(h) || mesh.is_border(o) || mesh.face(h) == mesh.face(o)) return false;
+
+        // Both faces may only share the edge itself, otherwise the joined polygon would not be simple
+        std::set<Mesh::Vertex_index> shared;
+        for (Mesh::Vertex_index v : CGAL::vertices_around_face(h, mesh)) shared.insert(v);
+        for (Mesh::Vertex_index v : CGAL::vertices_around_face(o, mesh)) {
+            if (v != mesh.source(h) && v != mesh.target(h) && shared.count(v)) return false;
+        }
+
+        // Faces folded onto each other have opposite normals
+        Vector nh = faceNormal(mesh, h);
+        Vector no = faceNormal(mesh, o);
+        double lh = std::sqrt(nh.squared_length());
+        double lo = std::sqrt(no.squared_length());
+        if (lh == 0.0 || lo == 0.0 || nh * no <= 0.0) return false;
+
+        // Every vertex of each face lies on the plane of the other one (both planes pass through the shared edge)
+        const Point& p = mesh.point(mesh.source(h));
+        for (Mesh::Vertex_index v : CGAL::vertices_around_face(o, mesh)) {
+            if (std::abs((mesh.point(v) - p) * nh) / lh > tolerance) return false;
+        }
+        for (Mesh::Vertex_index v : CGAL::vertices_around_face(h, mesh)) {
+            if (std::abs((mesh.point(v) - p) * no) / lo > tolerance) return false;
+        }
+
+        return true;
+    }
+
+
+    /**
+     *  Joins adjacent faces lying on the same plane into polygons, no vertex is moved or constructed
+     *  => the tolerance scales with the bounding box diagonal of the model
+     *
+     *  @param mesh             the mesh to merge the faces of
+     */
+    void mergeCoplanarFaces(Mesh& mesh) {
+        CGAL::Bbox_3 bbox;
+        for (Mesh::Vertex_index v : mesh.vertices()) bbox += mesh.point(v).bbox();
+
+        double dx = bbox.xmax() - bbox.xmin();
+        double dy = bbox.ymax() - bbox.ymin();
+        double dz = bbox.zmax() - bbox.zmin();
+        double tolerance = 1e-6 * std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        bool merged = true;
+        while (merged) {
+            merged = false;
+
+            std::vector<Mesh::Edge_index> edges(mesh.edges().begin(), mesh.edges().end());
+            for (Mesh::Edge_index e : edges) {
+                if (mesh.is_removed(e)) continue;
+
+                Mesh::Halfedge_index h = mesh.halfedge(e);
+                if (isMergeable(mesh, h, tolerance)) {
+                    CGAL::Euler::join_face(h, mesh);
+                    merged = true;
+                }
+            }
+        }
+
+        mesh.collect_garbage();
+    }
+}
+
+
+/// Simplifies a reconstructed model to a face budget and/ or error bound
+ECODE SurfRec::Mesh_Decimation::decimate(CGAL::Surface_mesh<Point>& model, struct SurfRec::md_options& parameter,
+                                            std::size_t& reachedFaces, bool planar) {
+    // 1) Check if options are well formatted: at least a face budget or an error bound must be given
+    if (parameter.targetFaces == 0 && parameter.maxCost <= 0.0) return ECODE::MD_WRONG_OPTIONS;
+
+    // A face budget which is already met stops the decimation, even if an error bound is given
+    bool budget = (parameter.targetFaces > 0);
+    std::size_t faces = model.number_of_faces();
+    reachedFaces = faces;
+    if (faces == 0 || (budget && parameter.targetFaces >= faces)) return ECODE::SUCCESS;
+
+    // 2) Planar output: only faces on the same plane are joined, so the budget is reached as far as exactness allows
+    if (planar) {
+        Mesh merged = model;
+        mergeCoplanarFaces(merged);
+
+        reachedFaces = merged.number_of_faces();
+        model = std::move(merged);
+        return ECODE::SUCCESS;
+    }
+
+    // 3) Edge collapse works on triangles only, the model is only replaced once decimation succeeded
+    Mesh mesh = model;
+    if (!CGAL::is_triangle_mesh(mesh) && !CGAL::Polygon_mesh_processing::triangulate_faces(mesh)) {
+        std::cerr << "[SurfRec::Mesh_Decimation::decimate] Model could not be triangulated!" << std::endl;
+        return ECODE::MD_DECIMATION_FAIL;
+    }
+
+    faces = mesh.number_of_faces();
+    double ratio = budget ? std::min(1.0, static_cast<double>(parameter.targetFaces) / static_cast<double>(faces)) : 1.0;
+
+    // 4) Split into partitions, small models are not worth a thread per partition
+    std::size_t threads = (parameter.threads == 0) ? std::thread::hardware_concurrency() : parameter.threads;
+    threads = std::max<std::size_t>(1, std::min<std::size_t>(threads, faces / 1024));
+
+    std::vector<std::vector<Mesh::Face_index>> cells = partitionFaces(mesh, threads);
+    std::vector<Partition> partitions(cells.size());
+
+    // 5) Simplify each partition in parallel
+    Budget_stop_predicate stop(budget, ratio, parameter.maxCost);
+    std::vector<char> failed(cells.size(), 0);
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        workers.emplace_back([&mesh, &cells, &stop, &partitions, &failed, i]() {
+            try {
+                decimatePartition(mesh, cells[i], stop, partitions[i]);
+            } catch (...) {
+                // CGAL reports failed preconditions by exceptions, they must not terminate the process
+                failed[i] = 1;
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+        std::cerr << "[SurfRec::Mesh_Decimation::decimate] Simplification of a partition failed!" << std::endl;
+        return ECODE::MD_DECIMATION_FAIL;
+    }
+
+    // 6) Stitch the partitions together, border vertices are shared as they were never moved
+    std::vector<Point> points;
+    std::vector<std::vector<std::size_t>> polygons;
+    std::map<Point, std::size_t> indices;
+
+    auto index = [&](const Point& p) {
+        auto it = indices.find(p);
+        if (it == indices.end()) {
+            it = indices.emplace(p, points.size()).first;
+            points.push_back(p);
+        }
+        return it->second;
+    };
+
+    for (const Partition& partition : partitions) {
+        for (Mesh::Face_index f : partition.mesh.faces()) {
+            std::vector<std::size_t> polygon;
+            for (Mesh::Vertex_index v : CGAL::vertices_around_face(partition.mesh.halfedge(f), partition.mesh)) {
+                polygon.push_back(index(partition.mesh.point(v)));
+            }
+            polygons.push_back(polygon);
+        }
+
+        for (const std::vector<Point>& kept : partition.kept) {
+            std::vector<std::size_t> polygon;
+            for (const Point& p : kept) polygon.push_back(index(p));
+            polygons.push_back(polygon);
+        }
+    }
+
+    if (!CGAL::Polygon_mesh_processing::is_polygon_soup_a_polygon_mesh(polygons)) {
+        std::cerr << "[SurfRec::Mesh_Decimation::decimate] Partitions could not be stitched together!" << std::endl;
+        return ECODE::MD_DECIMATION_FAIL;
+    }
+
+    Mesh decimated;
+    CGAL::Polygon_mesh_processing::polygon_soup_to_polygon_mesh(points, polygons, decimated);
+
+    // 7) Final pass over the whole model with the partition borders unlocked (only the remaining budget is collapsed)
+    std::size_t stitched = decimated.number_of_faces();
+    bool unmet = !budget || parameter.targetFaces < stitched;
+
+    if (cells.size() > 1 && unmet) {
+        double remaining = budget ? static_cast<double>(parameter.targetFaces) / static_cast<double>(stitched) : 1.0;
+
+        try {
+            SMS::edge_collapse(decimated, Budget_stop_predicate(budget, remaining, parameter.maxCost),
+                    CGAL::parameters::get_cost(SMS::LindstromTurk_cost<Mesh>())
+                        .get_placement(SMS::LindstromTurk_placement<Mesh>()));
+        } catch (...) {
+            std::cerr << "[SurfRec::Mesh_Decimation::decimate] Simplification of the partition borders failed!" << std::endl;
+            return ECODE::MD_DECIMATION_FAIL;
+        }
+        decimated.collect_garbage();
+    }
+
+    reachedFaces = decimated.number_of_faces();
+    model = std::move(decimated);
+
+    return ECODE::SUCCESS;
+}
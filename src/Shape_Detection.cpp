@@ -7,12 +7,15 @@
 
 /// Efficient RANSAC for shape detection
 // TODO: maybe add plane regularization (https://cgal.geometryfactory.com/CGAL/doc/master/Shape_detection/Shape_detection_2efficient_RANSAC_and_plane_regularization_8cpp-example.html)
-ECODE SurfRec::Shape_Detection::ransac(std::vector<PNI>& points) {
-    Efficient_ransac ransac;
+template<typename PointRange>
+ECODE SurfRec::Shape_Detection::ransac(PointRange& points) {
+    typedef Pipeline_traits<PointRange> Types;
+
+    typename Types::Efficient_ransac ransac;
     ransac.set_input(points);
 
     // The only shape useful with city models are planes
-    ransac.add_shape_factory<Plane>();
+    ransac.template add_shape_factory<typename Types::Plane>();
 
     // Detects the planes
     if (!ransac.detect()) {
@@ -20,9 +23,9 @@ ECODE SurfRec::Shape_Detection::ransac(std::vector<PNI>& points) {
     }
 
     // Stores the plane index of each point as third element to the tuple
-    Point_to_shape_index_map sim(points, ransac.planes());
+    typename Types::Point_to_shape_index_map sim(points, ransac.planes());
     for (int i = 0; i < points.size(); ++i) {
-        points[i].get<2>() = get(sim, i);
+        points[i].template get<2>() = get(sim, i);
     }
 
     return SUCCESS;
@@ -30,11 +33,14 @@ ECODE SurfRec::Shape_Detection::ransac(std::vector<PNI>& points) {
 
 
 /// Region growing for shape detection using file specific parameter
-ECODE SurfRec::Shape_Detection::region_growing(std::vector<PNI>& points, struct SurfRec::rg_params& parameter) {
-    Neighbor_query nq(points, parameter.par1);
-    Region_type rt(points, parameter.par2, parameter.par3, parameter.par4);
+template<typename PointRange>
+ECODE SurfRec::Shape_Detection::region_growing(PointRange& points, struct SurfRec::rg_params& parameter) {
+    typedef Pipeline_traits<PointRange> Types;
+
+    typename Types::Neighbor_query nq(points, parameter.par1);
+    typename Types::Region_type rt(points, parameter.par2, parameter.par3, parameter.par4);
 
-    Region_growing rg(points, nq, rt);
+    typename Types::Region_growing rg(points, nq, rt);
     std::vector<std::vector<std::size_t>> regions;
 
     // Detects regions
@@ -43,8 +49,16 @@ ECODE SurfRec::Shape_Detection::region_growing(std::vector<PNI>& points, struct
     // Stores the plane index of each point as third element to the tuple
     Index_map index_map(points, regions);
     for (int i = 0; i < points.size(); ++i) {
-        points[i].get<2>() = get(index_map, i);
+        points[i].template get<2>() = get(index_map, i);
     }
 
     return SUCCESS;
-}
\ No newline at end of file
+}
+
+
+/// Explicit instantiations exported from the library (robust and fast kernel)
+template ECODE SurfRec::Shape_Detection::ransac<std::vector<PNI>>(std::vector<PNI>&);
+template ECODE SurfRec::Shape_Detection::ransac<std::vector<Fast_PNI>>(std::vector<Fast_PNI>&);
+
+template ECODE SurfRec::Shape_Detection::region_growing<std::vector<PNI>>(std::vector<PNI>&, struct SurfRec::rg_params&);
+template ECODE SurfRec::Shape_Detection::region_growing<std::vector<Fast_PNI>>(std::vector<Fast_PNI>&, struct SurfRec::rg_params&);
\ No newline at end of file
@@ -43,31 +43,76 @@ ECODE SurfRec::polygonalReconstruction(std::string& path, struct SurfRec::option
         return status;
     }
 
+    // 5) Decimation of the model (if wanted), coplanar faces are joined so planar regions stay exact
+    if (algOptions.decimation) {
+        std::size_t faces;
+        if ((status = Mesh_Decimation::decimate(model, *(algOptions.decimation), faces, true)) != ECODE::SUCCESS) {
+            return status;
+        }
+    }
+
+    // 6) Save output to file
+    return File_Handling::writeModelToFile(model, path, algOptions.outputFormat);
+}
+
+
+/// Runs poisson surface reconstruction from given file and outputs it to new file
+ECODE SurfRec::poissonReconstruction(std::string& path, struct SurfRec::options& algOptions) {
+    // 1) Check if options are well formatted: detail options should be given if no detail level given
+    if (algOptions.detail.level == DETAIL::USER && !algOptions.detail.details) return ECODE::SR_WRONG_OPTIONS;
+
+    // 2) Load input from file
+    std::vector<PNI> points;
+
+    ECODE status;
+    if ((status = File_Handling::readPointsFromFile(points, path, algOptions.inputFormat)) != ECODE::SUCCESS) {
+        return status;
+    }
+
+    // 3) Surface reconstruction
+    CGAL::Surface_mesh<Point> model;
+    if ((status = poissonReconstruction(points, model, algOptions.detail)) != ECODE::SUCCESS) {
+        return status;
+    }
+
+    // 4) Decimation of the model (if wanted)
+    if (algOptions.decimation) {
+        std::size_t faces;
+        if ((status = Mesh_Decimation::decimate(model, *(algOptions.decimation), faces)) != ECODE::SUCCESS) {
+            return status;
+        }
+    }
+
     // 5) Save output to file
     return File_Handling::writeModelToFile(model, path, algOptions.outputFormat);
 }
 
 
-/// Runs polygonal surface reconstruction from given points and outputs to given model
-ECODE SurfRec::polygonalReconstruction(std::vector<PNI>& points, CGAL::Surface_mesh<Point>& model,
-                                        struct SurfRec::sr_options& level) {
-    Polygonal_surface_reconstruction algorithm(
-        points, Point_map(), Normal_map(), Plane_index_map()
-    );
+/**
+ *  Solves the MIP of an already constructed polygonal surface reconstruction (candidate faces and confidences given)
+ *
+ *  @param algorithm        the constructed reconstruction
+ *  @param model            output surface mesh
+ *  @param level            level of detail, the reconstruction should be
+ *  @return                 SUCCESS if reconstruction was successful, an error otherwise
+ */
+template<typename Algorithm, typename Mesh>
+ECODE solvePolygonal(Algorithm& algorithm, Mesh& model, struct SurfRec::sr_options& level) {
+    using SurfRec::DETAIL;
 
     bool ret = false;
     if (level.level == DETAIL::MOST) {
-        ret = algorithm.reconstruct<MIP_Solver>(model, 0.8, 0.15, 0.05);
+        ret = algorithm.template reconstruct<MIP_Solver>(model, 0.8, 0.15, 0.05);
     } else if (level.level == DETAIL::NORMAL) {
-        ret = algorithm.reconstruct<MIP_Solver>(model);
+        ret = algorithm.template reconstruct<MIP_Solver>(model);
     } else if (level.level == DETAIL::LESS) {
-        ret = algorithm.reconstruct<MIP_Solver>(model, 0.3, 0.2, 0.5);
+        ret = algorithm.template reconstruct<MIP_Solver>(model, 0.3, 0.2, 0.5);
     } else if (level.level == DETAIL::LEAST) {
-        ret = algorithm.reconstruct<MIP_Solver>(model, 0.2, 0.1, 0.7);
+        ret = algorithm.template reconstruct<MIP_Solver>(model, 0.2, 0.1, 0.7);
     } else if (level.level == DETAIL::USER) {
         // Check if level.details points to valid
         if (level.details) {
-            ret = algorithm.reconstruct<MIP_Solver>(
+            ret = algorithm.template reconstruct<MIP_Solver>(
                 model,
                 level.details->fitting,
                 level.details->coverage,
@@ -85,14 +130,43 @@ ECODE SurfRec::polygonalReconstruction(std::vector<PNI>& points, CGAL::Surface_m
 }
 
 
+/// Runs polygonal surface reconstruction from given points and outputs to given model
+template<typename PointRange>
+ECODE SurfRec::polygonalReconstruction(PointRange& points,
+                                        CGAL::Surface_mesh<typename Pipeline_traits<PointRange>::Point>& model,
+                                        struct SurfRec::sr_options& level) {
+    typedef Pipeline_traits<PointRange> Types;
+
+    // Parallel candidate generation is opt-in until checked against CGAL's one (see CandidateCheck)
+    if (level.threads == 1) {
+        typename Types::Polygonal_surface_reconstruction algorithm(
+            points, typename Types::Point_map(), typename Types::Normal_map(), typename Types::Plane_index_map()
+        );
+
+        return solvePolygonal(algorithm, model, level);
+    }
+
+    typename Types::Parallel_reconstruction algorithm(
+        points, typename Types::Point_map(), typename Types::Normal_map(), typename Types::Plane_index_map(),
+        level.threads
+    );
+
+    return solvePolygonal(algorithm, model, level);
+}
+
+
 /// Runs poisson surface reconstruction from given points and outputs to given model
 // TODO: evaluate return value of "CGAL::poisson_surface_reconstruction_delaunay" function
-ECODE SurfRec::poissonReconstruction(std::vector<PNI>& points, CGAL::Surface_mesh<Point>& model,
+template<typename PointRange>
+ECODE SurfRec::poissonReconstruction(PointRange& points,
+                                        CGAL::Surface_mesh<typename Pipeline_traits<PointRange>::Point>& model,
                                         struct SurfRec::sr_options& level) {
+    typedef Pipeline_traits<PointRange> Types;
+
     double average_spacing = CGAL::compute_average_spacing<CGAL::Sequential_tag>(
             points,
             6,
-            CGAL::parameters::point_map(Point_map())
+            CGAL::parameters::point_map(typename Types::Point_map())
     );
 
     bool ret = false;
@@ -101,7 +175,7 @@ ECODE SurfRec::poissonReconstruction(std::vector<PNI>& points, CGAL::Surface_mes
     } else if (level.level == DETAIL::NORMAL) {
         ret = CGAL::poisson_surface_reconstruction_delaunay(
                 points.begin(), points.end(),
-                Point_map(), Normal_map(),
+                typename Types::Point_map(), typename Types::Normal_map(),
                 model, average_spacing);
     } else if (level.level == DETAIL::LESS) {
         return SR_POISSON_NOT_IMPL;
@@ -110,7 +184,7 @@ ECODE SurfRec::poissonReconstruction(std::vector<PNI>& points, CGAL::Surface_mes
     } else if (level.level == DETAIL::USER) {
         ret = CGAL::poisson_surface_reconstruction_delaunay(
                 points.begin(), points.end(),
-                Point_map(), Normal_map(),
+                typename Types::Point_map(), typename Types::Normal_map(),
                 model, average_spacing,
                 level.details->fitting,
                 level.details->coverage,
@@ -123,4 +197,11 @@ ECODE SurfRec::poissonReconstruction(std::vector<PNI>& points, CGAL::Surface_mes
 
     std::cerr << "[SurfRec::poissonReconstruction] Some unknown error occured!" << std::endl;
     return SR_POLY_RECON_FAIL;
-}
\ No newline at end of file
+}
+
+
+/// Explicit instantiations exported from the library (robust kernel only, reconstruction needs filtered predicates)
+template ECODE SurfRec::polygonalReconstruction<std::vector<PNI>>(std::vector<PNI>&, CGAL::Surface_mesh<Point>&,
+                                                                    struct SurfRec::sr_options&);
+template ECODE SurfRec::poissonReconstruction<std::vector<PNI>>(std::vector<PNI>&, CGAL::Surface_mesh<Point>&,
+                                                                    struct SurfRec::sr_options&);
\ No newline at end of file